@@ -0,0 +1,110 @@
+#include "LocalMinBatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Usage: bench_locality [TABLE_MIB LANES]
+//
+// Minimizes many lanes over windows of a large memory mapped table, first
+// in lane order, then with requests ordered by the page they read.
+int main(int argc, char** argv) {
+    const std::size_t table_bytes = (argc == 3 ? std::strtoul(argv[1], nullptr, 10) : 512) << 20;
+    const std::size_t count = argc == 3 ? std::strtoul(argv[2], nullptr, 10) : 1 << 18;
+
+    // Each window of the table holds one period of a valley.
+    const std::size_t period = 4096;
+    const std::size_t samples = table_bytes / sizeof(double);
+    const std::size_t windows = samples / period - 1;
+    const double pi = std::acos(-1.0);
+
+    char path[] = "/tmp/bench_locality_XXXXXX";
+    const int file = mkstemp(path);
+    if (file < 0 || ftruncate(file, static_cast<off_t>(table_bytes)) != 0) {
+        std::perror("bench_locality");
+        return 1;
+    }
+    unlink(path);
+    void* const mapping = mmap(nullptr, table_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (mapping == MAP_FAILED) {
+        std::perror("bench_locality");
+        return 1;
+    }
+    double* const table = static_cast<double*>(mapping);
+    for (std::size_t k = 0; k < samples; ++k) {
+        table[k] = 1.0 - std::cos(2.0 * pi * static_cast<double>(k % period) / period + 0.001 * (k / period));
+    }
+
+    std::mt19937_64 random{42};
+    std::vector<std::size_t> bases(count);
+    for (auto& base : bases) {
+        base = (random() % windows) * period;
+    }
+
+    // The objective of a lane is its window smoothed by a box filter of 64
+    // taps, so each evaluation reads a block of about 512 bytes.
+    const std::size_t taps = 64;
+    auto evaluate = [&](const std::size_t lane, const double arg) {
+        const double position = std::clamp(arg, static_cast<double>(taps), static_cast<double>(period - taps));
+        const std::size_t first = static_cast<std::size_t>(position);
+        const double t = position - first;
+        const double* const block = table + bases[lane] + first - taps / 2;
+        double sum = 0.0;
+        for (std::size_t j = 0; j < taps; ++j) {
+            sum += block[j] + t * (block[j + 1] - block[j]);
+        }
+        return sum / taps;
+    };
+
+    auto run = [&](const bool ordered) {
+        LocalMinBatch batch{count, 0.0, static_cast<double>(period)};
+        if (ordered) {
+            batch.SetLocalityKey([&](std::size_t lane, double arg) {
+                return static_cast<std::uint64_t>((bases[lane] + static_cast<std::size_t>(arg)) * sizeof(double) / 4096);
+            });
+        }
+
+        std::vector<double> values;
+        std::size_t requests = 0;
+        double evaluation = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        while (!batch.IsReady()) {
+            const auto lanes = batch.Lanes();
+            const auto args = batch.Args();
+            values.resize(lanes.size());
+
+            const auto evaluation_start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < lanes.size(); ++i) {
+                values[i] = evaluate(lanes[i], args[i]);
+            }
+            const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - evaluation_start;
+            evaluation += seconds.count();
+            requests += lanes.size();
+
+            batch(values);
+        }
+        const std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+
+        std::printf("%10s %12zu %14.1f %12.3f\n", ordered ? "by page" : "by lane", requests,
+            requests / evaluation * 1e-6, total.count());
+    };
+
+    std::printf("table %zu MiB, %zu lanes\n\n", table_bytes >> 20, count);
+    std::printf("%10s %12s %14s %12s\n", "order", "requests", "Mrequests/s", "seconds");
+    run(false);
+    run(true);
+    run(false);
+    run(true);
+
+    munmap(mapping, table_bytes);
+    close(file);
+}
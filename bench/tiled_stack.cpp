@@ -0,0 +1,61 @@
+#include "LocalMinTiledStack.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Usage: bench_tiled_stack [WIDTH HEIGHT DEPTH]
+//
+// Minimizes a synthetic stack per pixel, first with different tile sizes on
+// one thread, then with the default tile size on a growing number of threads.
+int main(int argc, char** argv) {
+    const std::size_t width = argc == 4 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    const std::size_t height = argc == 4 ? std::strtoul(argv[2], nullptr, 10) : 2048;
+    const std::size_t depth = argc == 4 ? std::strtoul(argv[3], nullptr, 10) : 16;
+
+    // Every pixel has a smooth valley along the stack at its own position.
+    std::vector<float> stack(width * height * depth);
+    for (std::size_t k = 0; k < depth; ++k) {
+        for (std::size_t y = 0; y < height; ++y) {
+            for (std::size_t x = 0; x < width; ++x) {
+                const double center = 1.0 + (depth - 3.0) * (0.5 + 0.5 * std::sin(0.01 * x + 0.02 * y));
+                const double d = k - center;
+                stack[(k * height + y) * width + x] = static_cast<float>(1.0 - std::exp(-0.1 * d * d));
+            }
+        }
+    }
+
+    std::vector<double> args(width * height);
+    auto run = [&](const LocalMinTileOptions& options) {
+        const auto start = std::chrono::steady_clock::now();
+        LocalMinTiledStack<float>(stack, width, height, depth, args, {}, options);
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        return seconds.count();
+    };
+
+    std::printf("stack %zu x %zu x %zu\n\n", width, height, depth);
+
+    std::printf("%12s %10s %12s\n", "cache bytes", "seconds", "Mpixel/s");
+    for (const std::size_t cache_bytes : {16u << 10, 64u << 10, 256u << 10, 1u << 20, 4u << 20, 64u << 20}) {
+        LocalMinTileOptions options;
+        options.cache_bytes = cache_bytes;
+        options.threads = 1;
+        const double seconds = run(options);
+        std::printf("%12zu %10.3f %12.2f\n", cache_bytes, seconds, width * height / seconds * 1e-6);
+    }
+
+    std::printf("\n%12s %10s %12s %10s\n", "threads", "seconds", "Mpixel/s", "speedup");
+    double single = 0.0;
+    for (std::size_t threads = 1; threads <= std::max(std::thread::hardware_concurrency(), 1u); threads *= 2) {
+        LocalMinTileOptions options;
+        options.threads = threads;
+        const double seconds = run(options);
+        if (threads == 1) {
+            single = seconds;
+        }
+        std::printf("%12zu %10.3f %12.2f %10.2f\n", threads, seconds, width * height / seconds * 1e-6, single / seconds);
+    }
+}
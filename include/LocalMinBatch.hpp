@@ -0,0 +1,209 @@
+#pragma once
+
+#include "LocalMinReverseCommunication.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+//  Purpose:
+//
+//    LocalMinBatch() runs many LocalMinReverseCommunication() solvers in
+//    lockstep, using reverse communication for the whole batch.
+//
+//  Discussion:
+//
+//    Each solver is a lane.  After construction, Args() lists the
+//    arguments requested by all lanes that are not yet finished, and
+//    Lanes() the corresponding lane indices.  The user evaluates the
+//    function of each lane at its argument and passes the values, in the
+//    same order, to operator().  This is repeated until IsReady().
+//
+//    All requests of one round are independent of each other, so the user
+//    is free to evaluate them in any order or concurrently.
+//
+//    If the evaluation reads from a large dataset, the user may set a
+//    locality key, such as the index of the data block read for a lane at
+//    an argument.  The requests of each round are then sorted by key, and
+//    by lane within the same key, so that requests for the same block are
+//    adjacent and the blocks are visited in order.  The values are still
+//    passed in request order and are scattered back to the lanes.
+//
+//  Parameters
+//
+//    Input, std::vector<LocalMinReverseCommunication> SOLVERS, one freshly
+//    constructed solver per lane, possibly with different intervals.
+//
+//    Input, std::size_t COUNT, double A, B, DomainTransform TRANSFORM,
+//    ParabolaPolicy POLICY, alternatively COUNT lanes with the same setup.
+//
+//    Output, LocalMinResult Result(LANE, NOISE), the result of a lane, see
+//    LocalMinReverseCommunication::Result().
+//
+//    Input, std::function<std::uint64_t(std::size_t, double)> KEY, passed
+//    to SetLocalityKey(), the locality key of a lane at an argument.  Keys()
+//    lists the keys of the current requests.
+class LocalMinBatch {
+public:
+    explicit LocalMinBatch(std::vector<LocalMinReverseCommunication> lane_solvers)
+        : solvers(std::move(lane_solvers))
+    {
+        lanes.reserve(solvers.size());
+        args.reserve(solvers.size());
+        for (std::size_t lane = 0; lane < solvers.size(); ++lane)
+        {
+            lanes.push_back(lane);
+            args.push_back(solvers[lane](0.0));
+        }
+    }
+
+    LocalMinBatch(
+        const std::size_t count,
+        const double from,
+        const double to,
+        const DomainTransform domain_transform = DomainTransform::Identity,
+        const ParabolaPolicy parabola_policy = ParabolaPolicy::Standard
+    )
+        : LocalMinBatch(std::vector<LocalMinReverseCommunication>(
+            count, LocalMinReverseCommunication{from, to, domain_transform, parabola_policy}))
+    {}
+
+    auto IsReady() const -> bool {
+        return lanes.empty();
+    }
+
+    auto Size() const -> std::size_t {
+        return solvers.size();
+    }
+
+    auto Lanes() const -> std::span<const std::size_t> {
+        return key ? request_lanes : lanes;
+    }
+
+    auto Args() const -> std::span<const double> {
+        return key ? request_args : args;
+    }
+
+    auto Keys() const -> std::span<const std::uint64_t> {
+        return keys;
+    }
+
+    auto SetLocalityKey(std::function<std::uint64_t(std::size_t, double)> locality_key) -> void {
+        key = std::move(locality_key);
+        Sort();
+    }
+
+    auto operator()(std::span<const double> values) -> void {
+        if (values.size() != args.size())
+        {
+            throw std::runtime_error(std::format("LocalMinBatch: {} values are required, but {} were passed", args.size(), values.size()));
+        }
+
+        // Scatter the values back to lane order, so that the solvers are
+        // visited sequentially.
+        if (key)
+        {
+            lane_values.resize(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                lane_values[order[i]] = values[i];
+            }
+            values = lane_values;
+        }
+
+        // Finished lanes are removed, the order of the others is kept.
+        std::size_t pending = 0;
+        for (std::size_t i = 0; i < lanes.size(); ++i)
+        {
+            const std::size_t lane = lanes[i];
+            const double arg = solvers[lane](values[i]);
+            if (!solvers[lane].IsReady())
+            {
+                lanes[pending] = lane;
+                args[pending] = arg;
+                ++pending;
+            }
+        }
+        lanes.resize(pending);
+        args.resize(pending);
+        Sort();
+    }
+
+    auto Result(const std::size_t lane, const double noise = -1.0) const -> LocalMinResult {
+        return solvers[lane].Result(noise);
+    }
+
+private:
+    // Orders the requests by key, ORDER maps them back to lane order.  This
+    // is a stable radix sort, so equal keys stay in lane order, and it skips
+    // the digits in which all keys agree.
+    auto Sort() -> void {
+        if (!key)
+        {
+            return;
+        }
+
+        requests.resize(lanes.size());
+        std::uint64_t varying = 0;
+        for (std::size_t i = 0; i < lanes.size(); ++i)
+        {
+            requests[i] = {key(lanes[i], args[i]), i};
+            varying |= requests[i].first ^ requests.front().first;
+        }
+
+        sorted_requests.resize(requests.size());
+        for (int shift = 0; shift < 64 && (varying >> shift) != 0; shift += 8)
+        {
+            if (((varying >> shift) & 0xFF) == 0)
+            {
+                continue;
+            }
+
+            std::array<std::size_t, 257> offsets{};
+            for (const auto& request : requests)
+            {
+                ++offsets[((request.first >> shift) & 0xFF) + 1];
+            }
+            for (std::size_t digit = 1; digit < offsets.size(); ++digit)
+            {
+                offsets[digit] += offsets[digit - 1];
+            }
+            for (const auto& request : requests)
+            {
+                sorted_requests[offsets[(request.first >> shift) & 0xFF]++] = request;
+            }
+            requests.swap(sorted_requests);
+        }
+
+        keys.resize(requests.size());
+        order.resize(requests.size());
+        request_lanes.resize(requests.size());
+        request_args.resize(requests.size());
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            keys[i] = requests[i].first;
+            order[i] = requests[i].second;
+            request_lanes[i] = lanes[order[i]];
+            request_args[i] = args[order[i]];
+        }
+    }
+
+    std::vector<LocalMinReverseCommunication> solvers;
+    std::vector<std::size_t> lanes;
+    std::vector<double> args;
+    std::function<std::uint64_t(std::size_t, double)> key;
+    std::vector<std::pair<std::uint64_t, std::size_t>> requests;
+    std::vector<std::pair<std::uint64_t, std::size_t>> sorted_requests;
+    std::vector<std::uint64_t> keys;
+    std::vector<std::size_t> order;
+    std::vector<std::size_t> request_lanes;
+    std::vector<double> request_args;
+    std::vector<double> lane_values;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+
+//  Purpose:
+//
+//    LocalMinInterpolate() evaluates uniformly spaced samples at a
+//    fractional position.
+//
+//  Discussion:
+//
+//    The samples are interpolated with a Catmull-Rom cubic, which passes
+//    through the samples and has a continuous first derivative, so that the
+//    parabolic steps of LocalMinReverseCommunication() remain effective.
+//    The first and the last sample are repeated at the ends.
+//
+//  Parameters
+//
+//    Input, const double *SAMPLES, the samples at positions 0, 1, ...,
+//    COUNT - 1.  It is required that 2 <= COUNT.
+//
+//    Input, double POSITION, the position, in [0, COUNT - 1].
+inline auto LocalMinInterpolate(const double* const samples, const std::size_t count, const double position) -> double {
+    const double floor = std::clamp(std::floor(position), 0.0, static_cast<double>(count - 2));
+    const std::size_t i = static_cast<std::size_t>(floor);
+    const double t = position - floor;
+
+    const double p0 = samples[i == 0 ? 0 : i - 1];
+    const double p1 = samples[i];
+    const double p2 = samples[i + 1];
+    const double p3 = samples[std::min(i + 2, count - 1)];
+
+    return p1 + 0.5 * t * ((p2 - p0)
+        + t * ((2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3)
+        + t * (3.0 * (p1 - p2) + p3 - p0)));
+}
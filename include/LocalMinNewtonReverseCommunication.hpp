@@ -0,0 +1,333 @@
+#pragma once
+
+#include "LocalMinReverseCommunication.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+
+//  Purpose:
+//
+//    SecondOrderStep selects the step of LocalMinNewtonReverseCommunication().
+//
+//  Discussion:
+//
+//    Newton: U = X - F'(X) / F''(X).
+//
+//    Halley: Halley's step for the root of F', with F''' estimated from
+//    F'' at X and at the previous point.  Newton's step is used while
+//    there is no previous point.
+enum class SecondOrderStep {
+    Newton,
+    Halley,
+};
+
+
+//  Purpose:
+//
+//    LocalMinNewtonReverseCommunication() seeks a minimizer of a scalar
+//    function of a scalar variable, using its first and second derivative.
+//
+//  Discussion:
+//
+//    This is a variant of LocalMinReverseCommunication() for functions
+//    whose derivatives are cheap.  The user returns F, F' and F'' at each
+//    requested argument.
+//
+//    The routine maintains a bracket [A, B] and the best point X like
+//    LocalMinReverseCommunication().  In addition, the sign of F'(X)
+//    removes the half of the bracket on the ascending side of X.  A Newton
+//    or Halley step is taken if F''(X) is positive, the step stays inside
+//    the bracket, and it is less than half the step before last.
+//    Otherwise, as the parabolic step of LocalMinReverseCommunication(), a
+//    secant step for the root of F' through X and W is tried under the same
+//    conditions, which is the minimizer of the parabola with the slopes
+//    F'(X) and F'(W).  If it is rejected as well, a golden section step is
+//    taken into the descending side.
+//    Near a minimizer with positive second derivative, convergence is
+//    quadratic for Newton.  Halley is faster once the estimate of F''' is
+//    accurate, but its early steps may be worse.
+//
+//    Where F'' vanishes at the minimizer, these steps only converge
+//    linearly from one side.  So if neither the bracket shrank by half over
+//    two steps nor the step by half, a secant step for the root of
+//    F' / F'' through X and W is taken instead, whose root is simple.
+//
+//    The iteration is complete if the bracket is small enough, as in
+//    LocalMinReverseCommunication(), if the second order step is below the
+//    tolerance, or if F'(X) = 0 and F''(X) >= 0.  In all cases the best
+//    point X is returned.
+//
+//  Parameters
+//
+//    Input, double A, B, the endpoints of the initial interval.  It is
+//    required that A < B.
+//
+//    Input, SecondOrderStep STEP, the kind of second order step.
+//
+//    Input, double VALUE, DERIVATIVE, SECOND_DERIVATIVE, the function
+//    value and its derivatives at ARG, as requested by the routine on the
+//    previous call.
+//
+//    Output, double LocalMinNewtonReverseCommunication, the currently
+//    considered point.  If IsReady(), the estimate of the minimizer.
+//
+//    Output, LocalMinResult Result(NOISE), see
+//    LocalMinReverseCommunication::Result().  The curvature is F''(X).
+class LocalMinNewtonReverseCommunication {
+public:
+    LocalMinNewtonReverseCommunication(
+        const double from,
+        const double to,
+        const SecondOrderStep second_order_step = SecondOrderStep::Newton
+    )
+        : step(second_order_step)
+        , domain_a(from)
+        , domain_b(to)
+        , a(from)
+        , b(to)
+    {
+        if (b <= a)
+        {
+            throw std::runtime_error(std::format("LocalMinNewtonReverseCommunication: A < B is required, but A = {:f}; B = {:f}", a, b));
+        }
+    }
+
+    auto IsReady() const -> bool {
+        return iteration == 0;
+    }
+
+    auto Result(const double noise = -1.0) const -> LocalMinResult {
+        static const double tol = std::numeric_limits<double>::epsilon();
+        static const double eps = std::sqrt(tol);
+
+        LocalMinResult result;
+        result.arg = x;
+        result.value = fx;
+        result.curvature = hx;
+        result.lower = domain_a;
+        result.upper = domain_b;
+
+        if (hx <= 0.0)
+        {
+            return result;
+        }
+
+        const double level = noise < 0.0 ? tol * std::fabs(fx) : noise;
+        const double tol1 = eps * std::fabs(x) + tol / 3.0;
+        const double radius = std::max(std::sqrt(2.0 * level / hx), tol1);
+        result.lower = std::max(domain_a, x - radius);
+        result.upper = std::min(domain_b, x + radius);
+
+        return result;
+    }
+
+    auto operator()(const double value, const double derivative, const double second_derivative) -> double {
+        static const double tol = std::numeric_limits<double>::epsilon();
+        static const double eps = std::sqrt(tol);
+        static const double c = 0.5 * (3.0 - std::sqrt(5.0));
+
+        // First iteration
+        if (iteration == 0)
+        {
+            x = 0.5 * (a + b);
+            w = x;
+            d = b - a;
+            e = b - a;
+
+            iteration = 1;
+            arg = x;
+
+            return arg;
+        }
+        // Second iteration
+        else if (iteration == 1)
+        {
+            fx = value;
+            gx = derivative;
+            hx = second_derivative;
+        }
+        // Subsequent iterations, W keeps the other one of X and U.
+        else
+        {
+            const double u = arg;
+
+            if (value <= fx)
+            {
+                if (x <= u)
+                {
+                    a = x;
+                }
+                else
+                {
+                    b = x;
+                }
+                w = x;
+                gw = gx;
+                hw = hx;
+                x = u;
+                fx = value;
+                gx = derivative;
+                hx = second_derivative;
+            }
+            else
+            {
+                if (u < x)
+                {
+                    a = u;
+                }
+                else
+                {
+                    b = u;
+                }
+                w = u;
+                gw = derivative;
+                hw = second_derivative;
+            }
+        }
+
+        // The minimizer is on the descending side of X.
+        if (0.0 < gx)
+        {
+            b = x;
+        }
+        else if (gx < 0.0)
+        {
+            a = x;
+        }
+
+        // If the stopping criterion is satisfied, we can exit.
+        double midpoint = 0.5 * (a + b);
+        double tol1 = eps * std::fabs(x) + tol / 3.0;
+        double tol2 = 2.0 * tol1;
+
+        if (std::fabs(x - midpoint) <= (tol2 - 0.5 * (b - a)) || (gx == 0.0 && 0.0 <= hx))
+        {
+            iteration = 0;
+            arg = x;
+            return arg;
+        }
+
+        // The bracket must shrink by half over two steps.  Otherwise the
+        // steps only converge linearly, as at a minimizer with F'' = 0.
+        const bool slow = 0.5 * length_before_last < b - a;
+        length_before_last = length_before;
+        length_before = b - a;
+
+        // Try a second order step.
+        bool second_order = false;
+        if (0.0 < hx)
+        {
+            double s = - gx / hx;
+            if (step == SecondOrderStep::Halley && w != x)
+            {
+                const double third_derivative = (hx - hw) / (x - w);
+                const double denominator = 2.0 * hx * hx - gx * third_derivative;
+                if (0.0 < denominator)
+                {
+                    s = - 2.0 * gx * hx / denominator;
+                }
+            }
+
+            // The step is below the tolerance, so X is accurate enough.
+            if (std::fabs(s) <= tol1)
+            {
+                iteration = 0;
+                arg = x;
+                return arg;
+            }
+
+            second_order = Accept(s, slow);
+        }
+
+        // Otherwise try a secant step for the root of F', if the slopes at X
+        // and W imply a positive curvature.
+        if (!second_order && w != x && 0.0 < (gx - gw) / (x - w))
+        {
+            second_order = Accept(- gx * (x - w) / (gx - gw), slow);
+        }
+
+        // Otherwise take a golden section step into the descending side.
+        if (!second_order)
+        {
+            if (gx < 0.0 || (gx == 0.0 && x < midpoint))
+            {
+                e = b - x;
+            }
+            else
+            {
+                e = a - x;
+            }
+            d = c * e;
+        }
+
+        // F must not be evaluated too close to X.
+        if (tol1 <= std::fabs(d))
+        {
+            arg = x + d;
+        }
+        else
+        {
+            arg = x + std::copysign(tol1, d);
+        }
+
+        iteration = iteration + 1;
+
+        return arg;
+    }
+
+private:
+    // Takes the step S if it stays inside the bracket and is less than half
+    // the step before last.  If the bracket and the steps shrink slowly, a
+    // secant step for the root of F' / F'' through X and W is taken
+    // instead.  This function has a simple root even if F'' vanishes at the
+    // minimizer, so the step moves the far end of the bracket.
+    auto Accept(const double s, const bool slow) -> bool {
+        if (slow && 0.5 * std::fabs(d) <= std::fabs(s))
+        {
+            if (hx <= 0.0 || hw <= 0.0 || w == x || gx / hx == gw / hw)
+            {
+                return false;
+            }
+
+            const double root = - (gx / hx) * (x - w) / (gx / hx - gw / hw);
+            if (a < x + root && x + root < b)
+            {
+                e = d;
+                d = root;
+                return true;
+            }
+            return false;
+        }
+
+        if (a < x + s && x + s < b && std::fabs(s) < 0.5 * std::fabs(e))
+        {
+            e = d;
+            d = s;
+            return true;
+        }
+        return false;
+    }
+
+    SecondOrderStep step;
+    double domain_a;
+    double domain_b;
+    double a;
+    double b;
+    int iteration = 0;
+    double arg = 0.0;
+    double d = 0.0;
+    double e = 0.0;
+    double fx = 0.0;
+    double gw = 0.0;
+    double gx = 0.0;
+    double hx = 0.0;
+    double hw = 0.0;
+    double length_before = std::numeric_limits<double>::infinity();
+    double length_before_last = std::numeric_limits<double>::infinity();
+    double w = 0.0;
+    double x = 0.0;
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "LocalMinBatch.hpp"
+#include "LocalMinReverseCommunication.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+//  Purpose:
+//
+//    LocalMinPiecewise() seeks a minimizer of a function that is smooth
+//    between known breakpoints, such as tiered prices or clamped models.
+//
+//  Discussion:
+//
+//    The breakpoints split (A, B) into pieces.  The parabolic steps of
+//    LocalMinReverseCommunication() fail at the kinks, so a minimum at or
+//    near a breakpoint costs about as many evaluations as a pure golden
+//    section search.
+//
+//    In the first round, the function is requested at each breakpoint P and
+//    at P - 2 H, P - H, P + H and P + 2 H, with H = sqrt(EPS) * max(|P|,
+//    B - A).  This gives the value at P and the sign of the one-sided
+//    slopes into both adjacent pieces.  Each slope is taken from the two
+//    points on the same side of P, so F may jump at P.  Assuming that F is
+//    unimodal on each piece, a piece can only contain an interior
+//    minimizer if F descends into it from both ends; the outermost pieces
+//    are only checked at their breakpoint, since, as for
+//    LocalMinReverseCommunication(), a minimizer at A or B is not detected.
+//    All other pieces have their minimizer at an end, that is at P or, if
+//    F jumps there, within H of P, which is already evaluated.  A slope
+//    only counts as ascending if the difference exceeds the rounding error
+//    of the values, so a piece that is too flat to decide is solved.
+//
+//    The remaining pieces are solved by one LocalMinBatch(), so that all
+//    requests of a round come from different pieces and may be evaluated
+//    concurrently.  The result is the best of the breakpoints and the
+//    piece minimizers.
+//
+//  Parameters
+//
+//    Input, double A, B, the endpoints of the interval.  It is required
+//    that A < B.
+//
+//    Input, std::vector<double> BREAKPOINTS, the known points where F is
+//    not smooth, in any order.  It is required that they lie in (A, B) and
+//    are more than 4 * H apart.
+//
+//    Output, std::span<const double> Args(), the arguments requested in
+//    this round.  The function values are passed, in the same order, to
+//    operator().  This is repeated until IsReady().
+//
+//    Output, LocalMinResult Result(), the best point.  If it is a
+//    breakpoint or a point within 2 * H of one, its curvature is NaN and
+//    its interval is that point.
+class LocalMinPiecewise {
+public:
+    LocalMinPiecewise(const double from, const double to, std::vector<double> breakpoints)
+        : a(from)
+        , b(to)
+        , points(std::move(breakpoints))
+    {
+        static const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+        if (b <= a)
+        {
+            throw std::runtime_error(std::format("LocalMinPiecewise: A < B is required, but A = {:f}; B = {:f}", a, b));
+        }
+
+        std::sort(points.begin(), points.end());
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const double h = eps * std::max(std::fabs(points[i]), b - a);
+            const double previous = i == 0 ? a : points[i - 1] + 2.0 * h;
+            const double next = i + 1 == points.size() ? b : points[i + 1];
+            if (points[i] - 2.0 * h <= previous || next <= points[i] + 2.0 * h)
+            {
+                throw std::runtime_error(std::format("LocalMinPiecewise: breakpoints must be in (A, B) and apart, but P = {:f}", points[i]));
+            }
+            for (const double offset : {-2.0, -1.0, 0.0, 1.0, 2.0})
+            {
+                args.push_back(points[i] + offset * h);
+            }
+        }
+
+        if (points.empty())
+        {
+            StartPieces({true});
+        }
+    }
+
+    auto IsReady() const -> bool {
+        return Args().empty();
+    }
+
+    auto Args() const -> std::span<const double> {
+        if (!batch)
+        {
+            return args;
+        }
+        return batch->Args();
+    }
+
+    auto operator()(const std::span<const double> values) -> void {
+        if (batch)
+        {
+            (*batch)(values);
+            if (batch->IsReady())
+            {
+                for (std::size_t lane = 0; lane < batch->Size(); ++lane)
+                {
+                    const auto result = batch->Result(lane);
+                    if (result.value < best.value)
+                    {
+                        best = result;
+                    }
+                }
+            }
+            return;
+        }
+
+        if (values.size() != args.size())
+        {
+            throw std::runtime_error(std::format("LocalMinPiecewise: {} values are required, but {} were passed", args.size(), values.size()));
+        }
+
+        // Piece I lies between breakpoints I - 1 and I.  The slopes next to
+        // a breakpoint do not use the value at it, which is on one side of a
+        // jump.  A piece is only dropped if F clearly rises into it, since a
+        // difference at the rounding level may hide a descent.
+        std::vector<bool> descends_from_left(points.size() + 1, true);
+        std::vector<bool> descends_from_right(points.size() + 1, true);
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const double* const probe = values.data() + 5 * i;
+            descends_from_right[i] = !Rises(probe[1], probe[0]);
+            descends_from_left[i + 1] = !Rises(probe[3], probe[4]);
+
+            for (std::size_t j = 0; j < 5; ++j)
+            {
+                if (probe[j] < best.value)
+                {
+                    best.arg = args[5 * i + j];
+                    best.value = probe[j];
+                    best.lower = best.arg;
+                    best.upper = best.arg;
+                }
+            }
+        }
+        args.clear();
+
+        std::vector<bool> interior(points.size() + 1);
+        for (std::size_t i = 0; i < interior.size(); ++i)
+        {
+            interior[i] = descends_from_left[i] && descends_from_right[i];
+        }
+        StartPieces(interior);
+    }
+
+    auto Result() const -> LocalMinResult {
+        return best;
+    }
+
+private:
+    // True if TO exceeds FROM by more than the rounding error of both.
+    static auto Rises(const double from, const double to) -> bool {
+        static const double tol = std::numeric_limits<double>::epsilon();
+
+        return 4.0 * tol * std::max(std::fabs(from), std::fabs(to)) < to - from;
+    }
+
+    auto StartPieces(const std::vector<bool>& interior) -> void {
+        std::vector<LocalMinReverseCommunication> solvers;
+        for (std::size_t i = 0; i < interior.size(); ++i)
+        {
+            if (interior[i])
+            {
+                solvers.emplace_back(i == 0 ? a : points[i - 1], i == points.size() ? b : points[i]);
+            }
+        }
+
+        if (!solvers.empty())
+        {
+            batch.emplace(std::move(solvers));
+        }
+    }
+
+    double a;
+    double b;
+    std::vector<double> points;
+    std::vector<double> args;
+    std::optional<LocalMinBatch> batch;
+    LocalMinResult best{0.0, std::numeric_limits<double>::infinity()};
+};
@@ -1,8 +1,188 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <format>
+#include <stdexcept>
+
+
+//  Purpose:
+//
+//    DomainTransform selects the space in which LocalMinReverseCommunication()
+//    performs its golden section and parabolic steps.
+//
+//  Discussion:
+//
+//    The bracket logic always works on the transformed interval, while all
+//    requested arguments and the returned minimizer are in user space.  A
+//    transform is useful if the interval spans many orders of magnitude or
+//    is unbounded, since a golden step on the linear interval [1e-8, 1e2]
+//    spends most early evaluations near the upper end.
+//
+//    Identity: T(X) = X, for any finite interval.
+//
+//    Log: T(X) = log(X), requires 0 < A.
+//
+//    Logit: T(X) = log(X / (1 - X)), requires 0 < A and B < 1.
+//
+//    Arcsinh: T(X) = asinh(X), for any finite interval; behaves like a
+//    logarithm of |X| on both signs and is linear near zero.
+//
+//    SemiInfinite: for [A, inf) T(X) = L / (1 + L) with L = log(1 + S) and
+//    S = X - A, for (-inf, B] T(X) = -L / (1 + L) with S = B - X, and for
+//    (-inf, inf) T(X) = sign(X) L / (1 + L) with S = |X|.  At least one
+//    endpoint must be infinite; it is replaced by the largest finite value,
+//    so a function that decreases toward it is only requested at finite
+//    arguments.  Since the tolerance of the solver applies
+//    to T, the relative error in user space grows only with (1 + L)^2, not
+//    with S.
+enum class DomainTransform {
+    Identity,
+    Log,
+    Logit,
+    Arcsinh,
+    SemiInfinite,
+};
+
+
+//  Purpose:
+//
+//    ParabolaPolicy selects how LocalMinReverseCommunication() computes the
+//    parabolic interpolation step P / Q.
+//
+//  Discussion:
+//
+//    Standard: the plain formulas of Brent.
+//
+//    Compensated: the products and differences are evaluated with
+//    error-free transformations (TwoSum, and TwoProduct based on FMA), so
+//    that P and Q are nearly as accurate as if they were computed in twice
+//    the working precision.  As the bracket shrinks, the plain P and Q
+//    suffer from cancellation and the parabola is rejected in favor of a
+//    golden section or a minimum size step.  Note that the rounding error
+//    of the function values themselves is not removed, and it usually
+//    dominates, so the number of evaluations is often unchanged.
+enum class ParabolaPolicy {
+    Standard,
+    Compensated,
+};
+
+
+//  Purpose:
+//
+//    LocalMinParabola() computes the parabolic step of
+//    LocalMinReverseCommunication() from X, W, V and their function values.
+//
+//  Discussion:
+//
+//    The step from X to the vertex of the parabola is P / Q, with
+//
+//      R = (X - W) * (FX - FV)
+//      Q = (X - V) * (FX - FW)
+//      P = (X - V) * Q - (X - W) * R
+//      Q = 2 * (Q - R)
+//
+//    For ParabolaPolicy::Compensated, every rounding error of the
+//    differences and products is carried along as a low order part.  If
+//    this result is not finite, the standard formulas are used.
+struct LocalMinParabolaStep {
+    double p = 0.0;
+    double q = 0.0;
+};
+
+inline auto LocalMinParabola(
+    const double x,
+    const double w,
+    const double v,
+    const double fx,
+    const double fw,
+    const double fv,
+    const ParabolaPolicy policy = ParabolaPolicy::Standard
+) -> LocalMinParabolaStep {
+    if (policy == ParabolaPolicy::Compensated)
+    {
+        auto two_sum = [](const double lhs, const double rhs, double& error) {
+            const double sum = lhs + rhs;
+            const double part = sum - lhs;
+            error = (lhs - (sum - part)) + (rhs - part);
+            return sum;
+        };
+
+        auto two_product = [](const double lhs, const double rhs, double& error) {
+            const double product = lhs * rhs;
+            error = std::fma(lhs, rhs, -product);
+            return product;
+        };
+
+        double xw_error;
+        double xv_error;
+        double fv_error;
+        double fw_error;
+        const double xw = two_sum(x, -w, xw_error);
+        const double xv = two_sum(x, -v, xv_error);
+        const double dfv = two_sum(fx, -fv, fv_error);
+        const double dfw = two_sum(fx, -fw, fw_error);
+
+        // R and the first Q as double-double.
+        double r_low;
+        double q_low;
+        const double r_high = two_product(xw, dfv, r_low);
+        const double q_high = two_product(xv, dfw, q_low);
+        r_low += xw * fv_error + xw_error * dfv;
+        q_low += xv * fw_error + xv_error * dfw;
+
+        double first_error;
+        double second_error;
+        double sum_error;
+        const double first = two_product(xv, q_high, first_error);
+        const double second = two_product(-xw, r_high, second_error);
+        const double sum = two_sum(first, second, sum_error);
+        const double numerator = sum + (first_error + second_error + sum_error
+            + xv * q_low + xv_error * q_high - xw * r_low - xw_error * r_high);
+
+        double difference_error;
+        const double difference = two_sum(q_high, -r_high, difference_error);
+        const double denominator = 2.0 * (difference + (difference_error + q_low - r_low));
+
+        if (std::isfinite(numerator) && std::isfinite(denominator))
+        {
+            return {numerator, denominator};
+        }
+    }
+
+    const double r = (x - w) * (fx - fv);
+    const double q = (x - v) * (fx - fw);
+    return {(x - v) * q - (x - w) * r, 2.0 * (q - r)};
+}
+
+
+//  Purpose:
+//
+//    LocalMinResult describes the minimizer found by LocalMinReverseCommunication().
+//
+//  Discussion:
+//
+//    CURVATURE is the second derivative of F at ARG, taken from the
+//    parabola through the three points retained by the solver.  It is NaN
+//    if W or V is closer to X than EPS^(1/3) * max(|X|, 1), since the
+//    second difference is then dominated by rounding.  This is usually the
+//    case at convergence, so the curvature is only available after one
+//    call of Refine().
+//
+//    [LOWER, UPPER] is a confidence interval for the minimizer.  Its half
+//    width is sqrt(2 * NOISE / CURVATURE), the distance at which the
+//    parabola rises by the noise level of F, but at least the tolerance of
+//    the solver.  It is not clipped to the final bracket, which is only
+//    reliable for exact function values, but to the initial interval.  If
+//    CURVATURE is NaN or not positive, it is the initial interval.
+struct LocalMinResult {
+    double arg = 0.0;
+    double value = 0.0;
+    double curvature = std::numeric_limits<double>::quiet_NaN();
+    double lower = 0.0;
+    double upper = 0.0;
+};
 
 
 //  Purpose:
@@ -64,6 +244,25 @@
 //    bounds for an interval containing the minimizer.  It is required
 //    that A < B.
 //
+//    Input, DomainTransform TRANSFORM, the space in which the bracket is
+//    searched.  A and B must lie in the domain of the transform.
+//
+//    Input, ParabolaPolicy POLICY, how the parabolic step is computed.
+//
+//    Output, LocalMinResult Result(NOISE), after the iteration is complete,
+//    the best point, its function value, the curvature and a confidence
+//    interval for the minimizer.  NOISE is the absolute uncertainty of the
+//    function values; if it is negative, the rounding error of FX is used.
+//
+//    Output, double RefinementArg(), after the iteration is complete, a
+//    point for one more evaluation.  The solver keeps Y, the evaluated
+//    point closest to X that is at least EPS^(1/3) * max(|X|, 1) away from
+//    it.  The refinement point lies on the other side of X than Y, at the
+//    same distance, but at least EPS^(1/4) * max(|X|, 1).  Passing its
+//    function value to Refine(VALUE) retains X, Y and the new point, so
+//    the curvature is taken from points on both sides of X.  The bracket
+//    is not changed.  Refine() throws if the iteration is not complete.
+//
 //    Input/output, int &STATUS, used to communicate between
 //    the user and the routine.  The user only sets STATUS to zero on the first
 //    call, to indicate that this is a startup call.  The routine returns STATUS
@@ -86,20 +285,124 @@
 //    double EPS: the square root of the relative machine precision.
 class LocalMinReverseCommunication {
 public:
-    LocalMinReverseCommunication(const double from, const double to)
-        : a(from)
-        , b(to)
+    LocalMinReverseCommunication(
+        const double from,
+        const double to,
+        const DomainTransform domain_transform = DomainTransform::Identity,
+        const ParabolaPolicy parabola_policy = ParabolaPolicy::Standard
+    )
+        : transform(domain_transform)
+        , policy(parabola_policy)
     {
-        if (b <= a)
+        if (to <= from)
+        {
+            throw std::runtime_error(std::format("LocalMinReverseCommunication: A < B is required, but A = {:f}; B = {:f}", from, to));
+        }
+
+        if (transform == DomainTransform::SemiInfinite)
+        {
+            if (std::isfinite(from) && std::isfinite(to))
+            {
+                throw std::runtime_error(std::format("LocalMinReverseCommunication: SemiInfinite requires an infinite endpoint, but A = {:f}; B = {:f}", from, to));
+            }
+
+            if (std::isfinite(from))
+            {
+                origin = from;
+                orientation = 1;
+            }
+            else if (std::isfinite(to))
+            {
+                origin = to;
+                orientation = -1;
+            }
+        }
+
+        // An infinite endpoint is replaced by the largest finite value, so
+        // that every requested argument is finite.
+        static const double largest = std::numeric_limits<double>::max();
+        a = ToSolverSpace(std::max(from, -largest));
+        b = ToSolverSpace(std::min(to, largest));
+
+        if (!std::isfinite(a) || !std::isfinite(b) || b <= a)
         {
-            throw std::runtime_error(std::format("LocalMinReverseCommunication: A < B is required, but A = {:f}; B = {:f}", a, b));
+            throw std::runtime_error(std::format("LocalMinReverseCommunication: [A, B] is outside the domain of the transform, A = {:f}; B = {:f}", from, to));
         }
+
+        domain_a = a;
+        domain_b = b;
     }
 
     auto IsReady() const -> bool {
         return iteration == 0;
     }
 
+    auto Result(const double noise = -1.0) const -> LocalMinResult {
+        static const double tol = std::numeric_limits<double>::epsilon();
+        static const double eps = std::sqrt(tol);
+
+        static const double spacing = std::cbrt(tol);
+
+        LocalMinResult result;
+        result.arg = ToUserSpace(x);
+        result.value = fx;
+        result.lower = ToUserSpace(domain_a);
+        result.upper = ToUserSpace(domain_b);
+
+        const double minimum_spacing = spacing * std::max(std::fabs(x), 1.0);
+        if (std::fabs(x - w) < minimum_spacing || std::fabs(x - v) < minimum_spacing || w == v)
+        {
+            return result;
+        }
+
+        // Second divided difference of the parabola through X, W and V.
+        const double curvature = 2.0 * ((fx - fw) / (x - w) - (fx - fv) / (x - v)) / (w - v);
+        const double slope = DerivativeToSolverSpace(result.arg);
+        result.curvature = curvature * slope * slope;
+
+        if (curvature <= 0.0)
+        {
+            return result;
+        }
+
+        const double level = noise < 0.0 ? tol * std::fabs(fx) : noise;
+        const double tol1 = eps * std::fabs(x) + tol / 3.0;
+        const double radius = std::max(std::sqrt(2.0 * level / curvature), tol1);
+        result.lower = ToUserSpace(std::max(domain_a, x - radius));
+        result.upper = ToUserSpace(std::min(domain_b, x + radius));
+
+        return result;
+    }
+
+    auto RefinementArg() const -> double {
+        return ToUserSpace(RefinementPoint());
+    }
+
+    auto Refine(const double value) -> void {
+        if (!IsReady())
+        {
+            throw std::runtime_error("LocalMinReverseCommunication: Refine requires a complete iteration");
+        }
+
+        u = RefinementPoint();
+        fu = value;
+
+        v = y;
+        fv = fy;
+        if (fu < fx)
+        {
+            w = x;
+            fw = fx;
+            x = u;
+            fx = fu;
+        }
+        else
+        {
+            w = u;
+            fw = fu;
+        }
+    }
+
     auto operator()(const double value) -> double {
         static const double tol = std::numeric_limits<double>::epsilon();
         static const double eps = std::sqrt(tol);
@@ -112,12 +415,13 @@ public:
             v = a + c * (b - a);
             w = v;
             x = v;
+            y = v;
             e = 0.0;
 
             iteration = 1;
             arg = x;
 
-            return arg;
+            return ToUserSpace(arg);
         }
         // Second iteration
         else if (iteration == 1)
@@ -125,11 +429,14 @@ public:
             fx = value;
             fv = fx;
             fw = fx;
+            fy = fx;
         }
         // Subsequent iterations
         else if (2 <= iteration)
         {
             fu = value;
+            const double previous_x = x;
+            const double previous_fx = fx;
 
             if (fu <= fx)
             {
@@ -172,6 +479,9 @@ public:
                     fv = fu;
                 }
             }
+
+            KeepFarPoint(u, fu);
+            KeepFarPoint(previous_x, previous_fx);
         }
 
         // Take the next step.
@@ -183,7 +493,7 @@ public:
         if (std::fabs(x - midpoint) <= (tol2 - 0.5 * (b - a)))
         {
             iteration = 0;
-            return arg;
+            return ToUserSpace(arg);
         }
 
         // Is golden-section necessary?
@@ -202,10 +512,9 @@ public:
         // Consider fitting a parabola.
         else
         {
-            r = (x - w) * (fx - fv);
-            q = (x - v) * (fx - fw);
-            p = (x - v) * q - (x - w) * r;
-            q = 2.0 * (q - r);
+            const auto parabola = LocalMinParabola(x, w, v, fx, fw, fv, policy);
+            p = parabola.p;
+            q = parabola.q;
             if (0.0 < q)
             {
                 p = - p;
@@ -262,12 +571,113 @@ public:
         arg = u;
         iteration = iteration + 1;
 
-        return arg;
+        return ToUserSpace(arg);
     }
 
 private:
-    double a;
-    double b;
+    // Y keeps the evaluated point closest to X that is far enough from it
+    // for a second difference, see Refine().
+    auto KeepFarPoint(const double point, const double value) -> void {
+        static const double spacing = std::cbrt(std::numeric_limits<double>::epsilon());
+
+        const double minimum_spacing = spacing * std::max(std::fabs(x), 1.0);
+        const double distance = std::fabs(point - x);
+        if (minimum_spacing <= distance && (std::fabs(y - x) < minimum_spacing || distance < std::fabs(y - x)))
+        {
+            y = point;
+            fy = value;
+        }
+    }
+
+    auto RefinementPoint() const -> double {
+        static const double tol = std::numeric_limits<double>::epsilon();
+        static const double spacing = std::sqrt(std::sqrt(tol));
+
+        // The points retained at convergence are only about sqrt(EPS) apart,
+        // so their second difference is dominated by rounding.  Place the
+        // new point on the other side of X than Y, symmetric to it but at
+        // least at the optimal spacing of a second difference, and inside
+        // the initial interval.
+        const double step = std::max(spacing * std::max(std::fabs(x), 1.0), std::fabs(x - y));
+        if (x < y)
+        {
+            return std::max(x - step, 0.5 * (domain_a + x));
+        }
+        return std::min(x + step, 0.5 * (x + domain_b));
+    }
+
+    auto ToSolverSpace(const double value) const -> double {
+        switch (transform)
+        {
+        case DomainTransform::Identity:
+            return value;
+        case DomainTransform::Log:
+            return std::log(value);
+        case DomainTransform::Logit:
+            return std::log(value) - std::log1p(-value);
+        case DomainTransform::Arcsinh:
+            return std::asinh(value);
+        case DomainTransform::SemiInfinite:
+            {
+                const double s = orientation == 0 ? std::fabs(value) : orientation * (value - origin);
+                const double l = std::log1p(s);
+                return std::copysign(l / (1.0 + l), orientation == 0 ? value : orientation);
+            }
+        }
+        return value;
+    }
+
+    auto ToUserSpace(const double value) const -> double {
+        switch (transform)
+        {
+        case DomainTransform::Identity:
+            return value;
+        case DomainTransform::Log:
+            return std::exp(value);
+        case DomainTransform::Logit:
+            return 1.0 / (1.0 + std::exp(-value));
+        case DomainTransform::Arcsinh:
+            return std::sinh(value);
+        case DomainTransform::SemiInfinite:
+            {
+                const double t = orientation == 0 ? std::fabs(value) : orientation * value;
+                const double s = std::min(std::expm1(t / (1.0 - t)), std::numeric_limits<double>::max());
+                return std::clamp(orientation == 0 ? std::copysign(s, value) : origin + orientation * s,
+                    -std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+            }
+        }
+        return value;
+    }
+
+    auto DerivativeToSolverSpace(const double value) const -> double {
+        switch (transform)
+        {
+        case DomainTransform::Identity:
+            return 1.0;
+        case DomainTransform::Log:
+            return 1.0 / value;
+        case DomainTransform::Logit:
+            return 1.0 / (value * (1.0 - value));
+        case DomainTransform::Arcsinh:
+            return 1.0 / std::sqrt(1.0 + value * value);
+        case DomainTransform::SemiInfinite:
+            {
+                const double s = orientation == 0 ? std::fabs(value) : orientation * (value - origin);
+                const double l = std::log1p(s);
+                return 1.0 / ((1.0 + l) * (1.0 + l) * (1.0 + s));
+            }
+        }
+        return 1.0;
+    }
+
+    DomainTransform transform;
+    ParabolaPolicy policy;
+    double origin = 0.0;
+    int orientation = 0;
+    double domain_a = 0.0;
+    double domain_b = 0.0;
+    double a = 0.0;
+    double b = 0.0;
     int iteration = 0;
     double arg = 0.0;
     double c = 0.0;
@@ -277,6 +687,7 @@ private:
     double fv = 0.0;
     double fw = 0.0;
     double fx = 0.0;
+    double fy = 0.0;
     double p = 0.0;
     double q = 0.0;
     double r = 0.0;
@@ -284,4 +695,5 @@ private:
     double v = 0.0;
     double w = 0.0;
     double x = 0.0;
+    double y = 0.0;
 };
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "LocalMinInterpolation.hpp"
+#include "LocalMinReverseCommunication.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+
+//  Purpose:
+//
+//    LocalMinStreamMinimum is a refined minimum of LocalMinStream().
+//
+//  Discussion:
+//
+//    POSITION is measured in samples since the start of the stream, the
+//    first sample being at position 0.  VALUE is the interpolated signal at
+//    POSITION.  EVALUATIONS is the number of interpolations used to refine
+//    it, at most MAX_EVALUATIONS of LocalMinStream().
+struct LocalMinStreamMinimum {
+    double position = 0.0;
+    double value = 0.0;
+    int evaluations = 0;
+};
+
+
+//  Purpose:
+//
+//    LocalMinStream() detects and refines the minima of an unbounded
+//    signal, sample by sample.
+//
+//  Discussion:
+//
+//    A sample is a candidate if it is smaller than the RADIUS samples
+//    before it and not larger than the RADIUS samples after it, so a flat
+//    minimum is reported once.  As soon as the RADIUS samples after a
+//    candidate are known, its position is refined by a Brent search on the
+//    Catmull-Rom interpolation of the signal between its neighbors, using
+//    at most MAX_EVALUATIONS interpolations.  If the search is not complete
+//    by then, the best point found is reported.
+//
+//    Each minimum is therefore reported exactly RADIUS samples after the
+//    candidate sample, and the memory is 2 * RADIUS + 1 samples.  Minima
+//    within the first RADIUS samples are not reported.
+//
+//  Parameters
+//
+//    Input, std::size_t RADIUS, the half width of the detection window.
+//    It is required that 2 <= RADIUS.
+//
+//    Input, int MAX_EVALUATIONS, the evaluation budget per minimum.  It is
+//    required that 1 <= MAX_EVALUATIONS.
+//
+//    Input, double SAMPLE, the next sample, passed to Push().  The return
+//    value is the minimum completed by this sample, if any.
+class LocalMinStream {
+public:
+    explicit LocalMinStream(const std::size_t window_radius, const int evaluation_budget = 32)
+        : window(2 * window_radius + 1)
+        , radius(window_radius)
+        , max_evaluations(evaluation_budget)
+    {
+        if (radius < 2 || max_evaluations < 1)
+        {
+            throw std::runtime_error(std::format("LocalMinStream: 2 <= RADIUS and 1 <= MAX_EVALUATIONS are required, but RADIUS = {}; MAX_EVALUATIONS = {}", radius, max_evaluations));
+        }
+    }
+
+    auto Latency() const -> std::size_t {
+        return radius;
+    }
+
+    auto Push(const double sample) -> std::optional<LocalMinStreamMinimum> {
+        window[count % window.size()] = sample;
+        ++count;
+
+        if (count < window.size())
+        {
+            return std::nullopt;
+        }
+
+        // The candidate is in the middle of the window.
+        const std::uint64_t center = count - 1 - radius;
+        const double candidate = At(center);
+        for (std::size_t i = 1; i <= radius; ++i)
+        {
+            if (At(center - i) <= candidate || At(center + i) < candidate)
+            {
+                return std::nullopt;
+            }
+        }
+
+        return Refine(center);
+    }
+
+private:
+    auto At(const std::uint64_t index) const -> double {
+        return window[index % window.size()];
+    }
+
+    auto Refine(const std::uint64_t center) const -> LocalMinStreamMinimum {
+        // The interpolation between the neighbors of the candidate depends
+        // on the two samples on either side.
+        std::array<double, 5> samples;
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            samples[i] = At(center - 2 + i);
+        }
+
+        LocalMinStreamMinimum minimum;
+        minimum.position = 2.0;
+        minimum.value = samples[2];
+
+        LocalMinReverseCommunication local_min_rc{1.0, 3.0};
+        double value = 0.0;
+        for (int evaluation = 0; evaluation <= max_evaluations; ++evaluation)
+        {
+            const double arg = local_min_rc(value);
+            if (local_min_rc.IsReady() || evaluation == max_evaluations)
+            {
+                break;
+            }
+            value = LocalMinInterpolate(samples.data(), samples.size(), arg);
+            ++minimum.evaluations;
+            if (value < minimum.value)
+            {
+                minimum.position = arg;
+                minimum.value = value;
+            }
+        }
+
+        minimum.position += static_cast<double>(center) - 2.0;
+        return minimum;
+    }
+
+    std::vector<double> window;
+    std::size_t radius;
+    int max_evaluations;
+    std::uint64_t count = 0;
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "LocalMinBatch.hpp"
+#include "LocalMinInterpolation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+//  Purpose:
+//
+//    LocalMinTileOptions controls the tiling of LocalMinTiledStack().
+//
+//  Discussion:
+//
+//    CACHE_BYTES is the memory one tile may occupy, its samples as well as
+//    its solvers.  It should be about the size of the L2 cache of a core.
+//
+//    THREADS is the number of worker threads; 0 uses one per hardware
+//    thread.
+struct LocalMinTileOptions {
+    std::size_t cache_bytes = 256 * 1024;
+    std::size_t threads = 0;
+};
+
+
+//  Purpose:
+//
+//    LocalMinTiledStack() seeks, for every pixel of an image stack, the
+//    minimizer along the stack axis.
+//
+//  Discussion:
+//
+//    The objective of a pixel is the slice through the stack at this pixel,
+//    interpolated by LocalMinInterpolate() and minimized over [0, DEPTH - 1]
+//    by LocalMinReverseCommunication().
+//
+//    The image is processed in rectangular tiles.  The slices of a tile are
+//    gathered into a contiguous buffer, pixel by pixel, and all pixels of
+//    the tile are minimized by one LocalMinBatch().  The tile size is
+//    chosen such that the buffer and the solvers fit into CACHE_BYTES, so
+//    the evaluations of all iterations hit the cache.  Tiles are
+//    distributed dynamically over the worker threads.
+//
+//  Parameters
+//
+//    Input, std::span<const T> STACK, DEPTH planes of WIDTH * HEIGHT
+//    pixels each, plane after plane and row after row.  It is required
+//    that 2 <= DEPTH.
+//
+//    Output, std::span<double> ARGS, the minimizer of each pixel, row after
+//    row.
+//
+//    Output, std::span<double> VALUES, the interpolated minimum of each
+//    pixel, or empty if not needed.
+//
+//    Input, LocalMinTileOptions OPTIONS, the tiling.
+template <typename T>
+auto LocalMinTiledStack(
+    const std::span<const T> stack,
+    const std::size_t width,
+    const std::size_t height,
+    const std::size_t depth,
+    const std::span<double> args,
+    const std::span<double> values = {},
+    const LocalMinTileOptions& options = {}
+) -> void {
+    const std::size_t pixels = width * height;
+    if (depth < 2 || stack.size() != pixels * depth)
+    {
+        throw std::runtime_error(std::format("LocalMinTiledStack: a stack of {} x {} x {} with 2 <= DEPTH is required, but {} samples were passed", width, height, depth, stack.size()));
+    }
+    if (args.size() != pixels || (!values.empty() && values.size() != pixels))
+    {
+        throw std::runtime_error(std::format("LocalMinTiledStack: {} outputs per pixel are required", pixels));
+    }
+    if (pixels == 0)
+    {
+        return;
+    }
+
+    // Square tiles, as large as the cache permits.
+    const std::size_t pixel_bytes = depth * sizeof(double) + sizeof(LocalMinReverseCommunication)
+        + sizeof(std::size_t) + sizeof(double);
+    const std::size_t tile_pixels = std::max<std::size_t>(options.cache_bytes / pixel_bytes, 1);
+    const std::size_t side = std::max<std::size_t>(static_cast<std::size_t>(std::sqrt(static_cast<double>(tile_pixels))), 1);
+    const std::size_t tile_width = std::min(width, side);
+    const std::size_t tile_height = std::min(height, std::max<std::size_t>(tile_pixels / tile_width, 1));
+    const std::size_t tiles_x = (width + tile_width - 1) / tile_width;
+    const std::size_t tiles_y = (height + tile_height - 1) / tile_height;
+    const std::size_t tiles = tiles_x * tiles_y;
+
+    std::atomic<std::size_t> next_tile = 0;
+    auto worker = [&]() {
+        std::vector<double> samples;
+        std::vector<double> tile_values;
+
+        for (std::size_t tile = next_tile++; tile < tiles; tile = next_tile++)
+        {
+            const std::size_t x0 = (tile % tiles_x) * tile_width;
+            const std::size_t y0 = (tile / tiles_x) * tile_height;
+            const std::size_t w = std::min(tile_width, width - x0);
+            const std::size_t h = std::min(tile_height, height - y0);
+
+            // Gather the slices of the tile, reading the planes row-wise.
+            samples.resize(w * h * depth);
+            for (std::size_t k = 0; k < depth; ++k)
+            {
+                for (std::size_t y = 0; y < h; ++y)
+                {
+                    const T* const row = stack.data() + (k * height + y0 + y) * width + x0;
+                    for (std::size_t x = 0; x < w; ++x)
+                    {
+                        samples[(y * w + x) * depth + k] = static_cast<double>(row[x]);
+                    }
+                }
+            }
+
+            LocalMinBatch batch{w * h, 0.0, static_cast<double>(depth - 1)};
+            while (!batch.IsReady())
+            {
+                const auto lanes = batch.Lanes();
+                const auto lane_args = batch.Args();
+                tile_values.resize(lanes.size());
+                for (std::size_t i = 0; i < lanes.size(); ++i)
+                {
+                    tile_values[i] = LocalMinInterpolate(samples.data() + lanes[i] * depth, depth, lane_args[i]);
+                }
+                batch(tile_values);
+            }
+
+            for (std::size_t y = 0; y < h; ++y)
+            {
+                for (std::size_t x = 0; x < w; ++x)
+                {
+                    const auto result = batch.Result(y * w + x);
+                    const std::size_t pixel = (y0 + y) * width + x0 + x;
+                    args[pixel] = result.arg;
+                    if (!values.empty())
+                    {
+                        values[pixel] = result.value;
+                    }
+                }
+            }
+        }
+    };
+
+    const std::size_t hardware = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    const std::size_t threads = std::min(options.threads == 0 ? hardware : options.threads, tiles);
+
+    std::vector<std::jthread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+}
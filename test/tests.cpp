@@ -1,6 +1,103 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 #include "LocalMinReverseCommunication.hpp"
+#include "LocalMinBatch.hpp"
+#include "LocalMinTiledStack.hpp"
+#include "LocalMinStream.hpp"
+#include "LocalMinNewtonReverseCommunication.hpp"
+#include "LocalMinPiecewise.hpp"
+
+namespace {
+    struct Minimum {
+        double arg = 0.0;
+        int evaluations = 0;
+    };
+
+    template <typename Function>
+    auto Minimize(LocalMinReverseCommunication& local_min_rc, Function function) -> Minimum {
+        Minimum result;
+        double value = 0.0;
+        while (true) {
+            result.arg = local_min_rc(value);
+            if (local_min_rc.IsReady()) {
+                break;
+            }
+            value = function(result.arg);
+            ++result.evaluations;
+        }
+        return result;
+    }
+
+    struct SmoothProblem {
+        double from;
+        double to;
+        double minimizer;
+        double (*value)(double);
+        double (*derivative)(double);
+        double (*second_derivative)(double);
+    };
+
+    auto Minimize(LocalMinNewtonReverseCommunication& local_min_rc, const SmoothProblem& problem) -> Minimum {
+        Minimum result;
+        double value = 0.0;
+        double derivative = 0.0;
+        double second_derivative = 0.0;
+        while (true) {
+            result.arg = local_min_rc(value, derivative, second_derivative);
+            if (local_min_rc.IsReady()) {
+                break;
+            }
+            value = problem.value(result.arg);
+            derivative = problem.derivative(result.arg);
+            second_derivative = problem.second_derivative(result.arg);
+            ++result.evaluations;
+        }
+        return result;
+    }
+
+    template <typename Function>
+    auto Minimize(LocalMinPiecewise& local_min, Function function) -> Minimum {
+        Minimum result;
+        std::vector<double> values;
+        while (!local_min.IsReady()) {
+            values.clear();
+            for (const double arg : local_min.Args()) {
+                values.push_back(function(arg));
+            }
+            result.evaluations += static_cast<int>(values.size());
+            local_min(values);
+        }
+        result.arg = local_min.Result().arg;
+        return result;
+    }
+
+    const SmoothProblem smooth_problems[] = {
+        {-1.0, 2.0, std::log(2.0),
+            [](double x) { return std::exp(x) - 2.0 * x; },
+            [](double x) { return std::exp(x) - 2.0; },
+            [](double x) { return std::exp(x); }},
+        {-3.0, 2.0, 0.3,
+            [](double x) { return std::cosh(x - 0.3); },
+            [](double x) { return std::sinh(x - 0.3); },
+            [](double x) { return std::cosh(x - 0.3); }},
+        {0.0, 5.0, 2.0,
+            [](double x) { return std::log1p((x - 2.0) * (x - 2.0)); },
+            [](double x) { return 2.0 * (x - 2.0) / (1.0 + (x - 2.0) * (x - 2.0)); },
+            [](double x) { const double d2 = (x - 2.0) * (x - 2.0); return 2.0 * (1.0 - d2) / ((1.0 + d2) * (1.0 + d2)); }},
+        {0.0, 4.0, 1.0,
+            [](double x) { return x * x * x * x / 4.0 - x; },
+            [](double x) { return x * x * x - 1.0; },
+            [](double x) { return 3.0 * x * x; }},
+        // F''(3) = 0, so Newton's step alone converges only linearly.
+        {-10.0, 10.0, 3.0,
+            [](double x) { return std::pow(x - 3.0, 4.0); },
+            [](double x) { return 4.0 * std::pow(x - 3.0, 3.0); },
+            [](double x) { return 12.0 * std::pow(x - 3.0, 2.0); }},
+    };
+}
 
 TEST(LocalMinRCTest, MinimizesQuadraticFunction) {
     double a = 0.0;
@@ -41,3 +138,595 @@ TEST(LocalMinRCTest, MinimizesCosFunction) {
     // Actually, cos x has a minimum near x = pi, so check close to pi.
     EXPECT_NEAR(arg, 3.14159, 1e-3);
 }
+
+TEST(LocalMinRCTest, LogTransformNeedsFewerEvaluationsOnWideRange) {
+    // Regularization strength in [1e-8, 1e2] with a minimum at 1e-5.
+    auto function = [](double x) { return std::pow(std::log10(x) + 5.0, 2.0); };
+
+    LocalMinReverseCommunication linear{1e-8, 1e2};
+    LocalMinReverseCommunication logarithmic{1e-8, 1e2, DomainTransform::Log};
+    const auto linear_min = Minimize(linear, function);
+    const auto log_min = Minimize(logarithmic, function);
+
+    EXPECT_NEAR(log_min.arg, 1e-5, 1e-9);
+    EXPECT_LT(log_min.evaluations, linear_min.evaluations);
+    EXPECT_LT(log_min.evaluations, 15);
+}
+
+TEST(LocalMinRCTest, LogitTransformResolvesProbabilityNearZero) {
+    auto function = [](double p) { return std::pow(std::log(p / (1.0 - p)) + 12.0, 2.0); };
+
+    LocalMinReverseCommunication local_min_rc{1e-12, 1.0 - 1e-12, DomainTransform::Logit};
+    const auto min = Minimize(local_min_rc, function);
+
+    EXPECT_NEAR(min.arg, 1.0 / (1.0 + std::exp(12.0)), 1e-10);
+    EXPECT_LT(min.evaluations, 15);
+}
+
+TEST(LocalMinRCTest, ArcsinhTransformHandlesBothSigns) {
+    auto function = [](double x) { return std::pow(std::asinh(x) - std::asinh(-300.0), 2.0); };
+
+    LocalMinReverseCommunication linear{-1e6, 1e6};
+    LocalMinReverseCommunication arcsinh{-1e6, 1e6, DomainTransform::Arcsinh};
+    const auto linear_min = Minimize(linear, function);
+    const auto arcsinh_min = Minimize(arcsinh, function);
+
+    EXPECT_NEAR(arcsinh_min.arg, -300.0, 1e-4);
+    EXPECT_LT(arcsinh_min.evaluations, linear_min.evaluations);
+}
+
+TEST(LocalMinRCTest, SemiInfiniteTransformFindsMinimumOnUnboundedInterval) {
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    for (const double minimizer : {1e3, 1e6, 1e8}) {
+        auto function = [minimizer](double x) { return std::pow(std::log(x / minimizer), 2.0); };
+
+        // The tolerance applies in the compressed space, so the relative
+        // error grows with (1 + log(X))^2 in user space.
+        LocalMinReverseCommunication right{0.0, infinity, DomainTransform::SemiInfinite};
+        const auto right_min = Minimize(right, function);
+        EXPECT_NEAR(right_min.arg / minimizer, 1.0, 1e-5);
+        EXPECT_LT(right_min.evaluations, 25);
+
+        auto two_sided = [minimizer](double x) { return std::pow(std::asinh(x) - std::asinh(minimizer), 2.0); };
+        LocalMinReverseCommunication both{-infinity, infinity, DomainTransform::SemiInfinite};
+        EXPECT_NEAR(Minimize(both, two_sided).arg / minimizer, 1.0, 1e-5);
+    }
+
+    auto function = [](double x) { return std::pow(x - 1000.0, 2.0); };
+    LocalMinReverseCommunication left{-infinity, 2000.0, DomainTransform::SemiInfinite};
+    EXPECT_NEAR(Minimize(left, function).arg / 1000.0, 1.0, 1e-5);
+}
+
+TEST(LocalMinRCTest, SemiInfiniteTransformRequestsFiniteArgumentsForMonotoneFunction) {
+    const double infinity = std::numeric_limits<double>::infinity();
+    struct Problem {
+        double from;
+        double to;
+        double (*function)(double);
+        int max_evaluations;
+    };
+    const Problem problems[] = {
+        {0.0, infinity, [](double x) { return -x; }, 50},
+        {-infinity, 0.0, [](double x) { return x; }, 50},
+        {-infinity, infinity, [](double x) { return -x; }, 50},
+        // F decays like exp(-L) in the compressed space, so the parabolic steps are slow.
+        {0.0, infinity, [](double x) { return 1.0 / (1.0 + x); }, 200},
+    };
+
+    for (const auto& problem : problems) {
+        LocalMinReverseCommunication local_min_rc{problem.from, problem.to, DomainTransform::SemiInfinite};
+        bool finite = true;
+        const auto min = Minimize(local_min_rc, [&](double x) {
+            finite = finite && std::isfinite(x);
+            return problem.function(x);
+        });
+
+        EXPECT_TRUE(finite);
+        EXPECT_TRUE(std::isfinite(min.arg));
+        EXPECT_GT(std::fabs(min.arg), 1e300);
+        EXPECT_LT(min.evaluations, problem.max_evaluations);
+    }
+}
+
+TEST(LocalMinRCTest, RejectsIntervalOutsideTransformDomain) {
+    EXPECT_THROW((LocalMinReverseCommunication{0.0, 1.0, DomainTransform::Log}), std::runtime_error);
+    EXPECT_THROW((LocalMinReverseCommunication{0.5, 1.0, DomainTransform::Logit}), std::runtime_error);
+    EXPECT_THROW((LocalMinReverseCommunication{0.0, 1.0, DomainTransform::SemiInfinite}), std::runtime_error);
+}
+
+TEST(LocalMinRCTest, ResultCurvatureIsNotRoundingNoise) {
+    struct Problem {
+        double from;
+        double to;
+        double minimizer;
+        double curvature;
+        double tolerance;
+        double (*function)(double);
+    };
+    const Problem problems[] = {
+        {-1.0, 2.0, std::log(2.0), 2.0, 1e-4, [](double x) { return std::exp(x) - 2.0 * x; }},
+        {-3.0, 2.0, 0.3, 1.0, 1e-4, [](double x) { return std::cosh(x - 0.3); }},
+        // The rounding error of F is 1e-10, so the second difference is only accurate to about 1e-3.
+        {0.0, 5.0, 2.0, 2.0, 1e-2, [](double x) { return 1e6 + (x - 2.0) * (x - 2.0); }},
+    };
+
+    for (const auto& problem : problems) {
+        LocalMinReverseCommunication local_min_rc{problem.from, problem.to};
+        Minimize(local_min_rc, problem.function);
+
+        // The retained points are too close for a second difference, so
+        // there is no curvature and the interval is the initial one.
+        const auto result = local_min_rc.Result();
+        EXPECT_NEAR(result.arg, problem.minimizer, 1e-6);
+        EXPECT_TRUE(std::isnan(result.curvature));
+        EXPECT_EQ(result.lower, problem.from);
+        EXPECT_EQ(result.upper, problem.to);
+
+        local_min_rc.Refine(problem.function(local_min_rc.RefinementArg()));
+        const auto refined = local_min_rc.Result();
+        EXPECT_NEAR(refined.curvature / problem.curvature, 1.0, problem.tolerance);
+        EXPECT_LE(refined.lower, problem.minimizer);
+        EXPECT_GE(refined.upper, problem.minimizer);
+    }
+}
+
+TEST(LocalMinRCTest, ResultIntervalGrowsWithNoise) {
+    auto function = [](double x) { return (x - 2.0) * (x - 2.0); };
+
+    LocalMinReverseCommunication local_min_rc{0.0, 5.0};
+    Minimize(local_min_rc, function);
+    local_min_rc.Refine(function(local_min_rc.RefinementArg()));
+
+    // A parabola with curvature 2 rises by 1e-6 at a distance of 1e-3.
+    const auto result = local_min_rc.Result(1e-6);
+    EXPECT_NEAR(result.curvature, 2.0, 1e-6);
+    EXPECT_NEAR(result.lower, 2.0 - 1e-3, 1e-5);
+    EXPECT_NEAR(result.upper, 2.0 + 1e-3, 1e-5);
+}
+
+TEST(LocalMinRCTest, RefineUsesOneEvaluation) {
+    auto function = [](double x) { return std::exp(x) - 2.0 * x; };
+
+    LocalMinReverseCommunication local_min_rc{-1.0, 2.0};
+    Minimize(local_min_rc, function);
+    local_min_rc.Refine(function(local_min_rc.RefinementArg()));
+
+    // F''(log(2)) = 2
+    const auto result = local_min_rc.Result();
+    EXPECT_NEAR(result.arg, std::log(2.0), 1e-6);
+    EXPECT_NEAR(result.curvature, 2.0, 1e-3);
+}
+
+TEST(LocalMinRCTest, RefineRequiresCompleteIteration) {
+    LocalMinReverseCommunication local_min_rc{0.0, 5.0};
+    const double arg = local_min_rc(0.0);
+    local_min_rc(arg * arg);
+    EXPECT_THROW(local_min_rc.Refine(0.0), std::runtime_error);
+}
+
+TEST(LocalMinRCTest, ResultCurvatureIsInUserSpace) {
+    auto function = [](double x) { return std::pow(std::log(x) + 5.0, 2.0); };
+
+    LocalMinReverseCommunication local_min_rc{1e-8, 1e2, DomainTransform::Log};
+    Minimize(local_min_rc, function);
+    local_min_rc.Refine(function(local_min_rc.RefinementArg()));
+
+    // F''(exp(-5)) = 2 * exp(10)
+    const auto result = local_min_rc.Result();
+    EXPECT_NEAR(result.arg, std::exp(-5.0), 1e-9);
+    EXPECT_NEAR(result.curvature / (2.0 * std::exp(10.0)), 1.0, 1e-3);
+    EXPECT_LT(result.lower, result.arg);
+    EXPECT_GT(result.upper, result.arg);
+}
+
+TEST(LocalMinRCTest, CompensatedParabolaOnFlatAndIllConditionedFunctions) {
+    struct Problem {
+        double from;
+        double to;
+        double minimizer;
+        double (*function)(double);
+    };
+    const Problem problems[] = {
+        // Flat: quartic minimum
+        {0.0, 5.0, 2.0, [](double x) { return std::pow(x - 2.0, 4.0); }},
+        // Flat: exp(x) - 2x near log(2)
+        {-1.0, 2.0, std::log(2.0), [](double x) { return std::exp(x) - 2.0 * x; }},
+        // Ill-conditioned: large offset in F
+        {0.0, 5.0, 2.0, [](double x) { return 1e6 + (x - 2.0) * (x - 2.0); }},
+        // Ill-conditioned: large offset in X
+        {1e6, 1e6 + 5.0, 1e6 + 2.0, [](double x) { return std::cosh(x - 1e6 - 2.0); }},
+    };
+
+    for (const auto& problem : problems) {
+        LocalMinReverseCommunication standard{problem.from, problem.to};
+        LocalMinReverseCommunication compensated{
+            problem.from, problem.to, DomainTransform::Identity, ParabolaPolicy::Compensated};
+        const auto standard_min = Minimize(standard, problem.function);
+        const auto compensated_min = Minimize(compensated, problem.function);
+
+        // The solver tolerance is relative to sqrt(epsilon) * |X|.
+        EXPECT_NEAR(compensated.Result().arg, problem.minimizer, 1e-3 + 2e-8 * std::fabs(problem.minimizer));
+        EXPECT_LE(compensated_min.evaluations, standard_min.evaluations);
+    }
+}
+
+TEST(LocalMinRCTest, CompensatedParabolaMatchesExtendedPrecision) {
+    if (std::numeric_limits<long double>::digits < 64) {
+        GTEST_SKIP() << "long double is not more precise than double";
+    }
+
+    // Clustered points near a minimizer, as at the end of the iteration.
+    struct Points {
+        double x;
+        double w;
+        double v;
+    };
+    const Points clusters[] = {
+        {1.0, 1.0 + 3e-8, 1.0 - 5e-8},
+        {0.7 + 1e-6, 0.7 - 2e-7, 0.7 + 3e-6},
+        {5.0, 5.0 + 7e-8, 5.0 - 4e-8},
+    };
+    auto function = [](double t) { return std::cosh(t - 0.7) + std::exp(-t); };
+
+    double standard_error = 0.0;
+    for (const auto& points : clusters) {
+        const double fx = function(points.x);
+        const double fw = function(points.w);
+        const double fv = function(points.v);
+
+        // The same formulas in long double, from the same double inputs.
+        // Its own error is up to about 1e-14 after the cancellation in Q.
+        const long double x = points.x;
+        const long double w = points.w;
+        const long double v = points.v;
+        const long double r = (x - w) * (fx - static_cast<long double>(fv));
+        const long double q = (x - v) * (fx - static_cast<long double>(fw));
+        const long double p = (x - v) * q - (x - w) * r;
+        const long double denominator = 2.0L * (q - r);
+
+        const auto standard = LocalMinParabola(points.x, points.w, points.v, fx, fw, fv);
+        const auto compensated = LocalMinParabola(points.x, points.w, points.v, fx, fw, fv, ParabolaPolicy::Compensated);
+
+        EXPECT_NEAR(static_cast<double>((compensated.p - p) / p), 0.0, 1e-13);
+        EXPECT_NEAR(static_cast<double>((compensated.q - denominator) / denominator), 0.0, 1e-13);
+        standard_error = std::max(standard_error, static_cast<double>(std::fabs((standard.q - denominator) / denominator)));
+    }
+
+    // Otherwise the clusters would not test the compensation.
+    EXPECT_GT(standard_error, 1e-10);
+}
+
+TEST(LocalMinBatchTest, MinimizesEveryLane) {
+    const std::vector<double> minimizers{0.5, 2.0, 3.5, 4.0};
+
+    LocalMinBatch batch{minimizers.size(), 0.0, 5.0};
+    std::vector<double> values;
+    int rounds = 0;
+    while (!batch.IsReady()) {
+        values.clear();
+        for (std::size_t i = 0; i < batch.Lanes().size(); ++i) {
+            const double d = batch.Args()[i] - minimizers[batch.Lanes()[i]];
+            values.push_back(d * d);
+        }
+        batch(values);
+        ++rounds;
+    }
+
+    EXPECT_LT(rounds, 20);
+    for (std::size_t lane = 0; lane < minimizers.size(); ++lane) {
+        EXPECT_NEAR(batch.Result(lane).arg, minimizers[lane], 1e-6);
+    }
+}
+
+TEST(LocalMinBatchTest, RejectsWrongNumberOfValues) {
+    LocalMinBatch batch{3, 0.0, 1.0};
+    const std::vector<double> values(2, 0.0);
+    EXPECT_THROW(batch(values), std::runtime_error);
+}
+
+TEST(LocalMinBatchTest, OrdersRequestsByLocalityKey) {
+    // Lane i minimizes a parabola centered in data block (7 * i) % 10.
+    const std::size_t count = 10;
+    auto center = [](std::size_t lane) { return static_cast<double>((7 * lane) % 10) + 0.5; };
+
+    LocalMinBatch unordered{count, 0.0, 10.0};
+    std::vector<double> values;
+    while (!unordered.IsReady()) {
+        values.clear();
+        for (std::size_t i = 0; i < unordered.Lanes().size(); ++i) {
+            const double d = unordered.Args()[i] - center(unordered.Lanes()[i]);
+            values.push_back(d * d);
+        }
+        unordered(values);
+    }
+
+    LocalMinBatch batch{count, 0.0, 10.0};
+    batch.SetLocalityKey([](std::size_t, double arg) { return static_cast<std::uint64_t>(arg); });
+
+    while (!batch.IsReady()) {
+        EXPECT_TRUE(std::is_sorted(batch.Keys().begin(), batch.Keys().end()));
+        ASSERT_EQ(batch.Keys().size(), batch.Args().size());
+        values.clear();
+        for (std::size_t i = 0; i < batch.Lanes().size(); ++i) {
+            EXPECT_EQ(batch.Keys()[i], static_cast<std::uint64_t>(batch.Args()[i]));
+            const double d = batch.Args()[i] - center(batch.Lanes()[i]);
+            values.push_back(d * d);
+        }
+        batch(values);
+    }
+
+    // The values reach the same lanes as without ordering.
+    for (std::size_t lane = 0; lane < count; ++lane) {
+        EXPECT_NEAR(batch.Result(lane).arg, center(lane), 1e-6);
+        EXPECT_EQ(batch.Result(lane).arg, unordered.Result(lane).arg);
+    }
+}
+
+TEST(LocalMinTiledStackTest, MatchesPerPixelMinimization) {
+    const std::size_t width = 37;
+    const std::size_t height = 23;
+    const std::size_t depth = 12;
+
+    // Each pixel has a parabola along the stack with its own minimizer.
+    auto minimizer = [](std::size_t x, std::size_t y) { return 2.0 + 0.1 * x + 0.1 * y; };
+    std::vector<float> stack(width * height * depth);
+    for (std::size_t k = 0; k < depth; ++k) {
+        for (std::size_t y = 0; y < height; ++y) {
+            for (std::size_t x = 0; x < width; ++x) {
+                const double d = k - minimizer(x, y);
+                stack[(k * height + y) * width + x] = static_cast<float>(d * d);
+            }
+        }
+    }
+
+    // A small cache forces many tiles, including partial ones at the border.
+    std::vector<double> args(width * height);
+    std::vector<double> values(width * height);
+    LocalMinTileOptions options;
+    options.cache_bytes = 16 * 1024;
+    options.threads = 3;
+    LocalMinTiledStack<float>(stack, width, height, depth, args, values, options);
+
+    std::vector<double> slice(depth);
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            for (std::size_t k = 0; k < depth; ++k) {
+                slice[k] = stack[(k * height + y) * width + x];
+            }
+            LocalMinReverseCommunication local_min_rc{0.0, depth - 1.0};
+            Minimize(local_min_rc, [&](double z) { return LocalMinInterpolate(slice.data(), depth, z); });
+
+            const std::size_t pixel = y * width + x;
+            EXPECT_EQ(args[pixel], local_min_rc.Result().arg);
+            EXPECT_EQ(values[pixel], local_min_rc.Result().value);
+            EXPECT_NEAR(args[pixel], minimizer(x, y), 0.1);
+        }
+    }
+}
+
+TEST(LocalMinStreamTest, RefinesMinimaWithFixedLatency) {
+    const double frequency = 0.3;
+    const double pi = std::acos(-1.0);
+
+    LocalMinStream stream{4};
+    std::vector<double> positions;
+    for (int t = 0; t < 200; ++t) {
+        if (const auto minimum = stream.Push(std::sin(frequency * t))) {
+            // Reported exactly Latency() samples after the candidate sample.
+            EXPECT_EQ(std::round(minimum->position), t - static_cast<double>(stream.Latency()));
+            EXPECT_NEAR(minimum->value, -1.0, 1e-3);
+            positions.push_back(minimum->position);
+        }
+    }
+
+    // sin(0.3 t) has its minima at t = (3 pi / 2 + 2 pi k) / 0.3.
+    ASSERT_EQ(positions.size(), 9u);
+    for (std::size_t k = 0; k < positions.size(); ++k) {
+        EXPECT_NEAR(positions[k], (1.5 * pi + 2.0 * pi * k) / frequency, 1e-2);
+    }
+}
+
+TEST(LocalMinStreamTest, ReportsFlatMinimumOnce) {
+    LocalMinStream stream{2};
+    int minima = 0;
+    for (const double sample : {5.0, 4.0, 3.0, 1.0, 1.0, 1.0, 3.0, 4.0, 5.0, 6.0}) {
+        if (stream.Push(sample)) {
+            ++minima;
+        }
+    }
+    EXPECT_EQ(minima, 1);
+}
+
+TEST(LocalMinStreamTest, RespectsEvaluationBudget) {
+    LocalMinStream stream{2, 3};
+    std::optional<LocalMinStreamMinimum> minimum;
+    for (const double sample : {4.0, 1.0, 0.2, 0.0, 0.9, 4.0, 9.0}) {
+        if (const auto result = stream.Push(sample)) {
+            minimum = result;
+        }
+    }
+    ASSERT_TRUE(minimum.has_value());
+    EXPECT_EQ(minimum->evaluations, 3);
+    EXPECT_GT(minimum->position, 2.0);
+    EXPECT_LT(minimum->position, 4.0);
+    EXPECT_LE(minimum->value, 0.0);
+
+    // With a budget of one, only the first golden section point is tried.
+    LocalMinStream single{2, 1};
+    std::optional<LocalMinStreamMinimum> first;
+    for (const double sample : {4.0, 1.0, 0.2, 0.0, 0.9, 4.0, 9.0}) {
+        if (const auto result = single.Push(sample)) {
+            first = result;
+        }
+    }
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->evaluations, 1);
+    const double golden = 1.0 + 0.5 * (3.0 - std::sqrt(5.0)) * 2.0;
+    EXPECT_TRUE(first->position == 1.0 + golden || first->position == 3.0);
+}
+
+TEST(LocalMinNewtonRCTest, NeedsFewerEvaluationsThanValueOnlySolver) {
+    for (const auto& problem : smooth_problems) {
+        LocalMinReverseCommunication value_only{problem.from, problem.to};
+        LocalMinNewtonReverseCommunication newton{problem.from, problem.to};
+        const auto value_only_min = Minimize(value_only, problem.value);
+        const auto newton_min = Minimize(newton, problem);
+
+        // The tolerance of the solver is about sqrt(epsilon).
+        EXPECT_NEAR(newton_min.arg, problem.minimizer, 1e-7);
+        EXPECT_LT(newton_min.evaluations, value_only_min.evaluations);
+        EXPECT_DOUBLE_EQ(newton.Result().curvature, problem.second_derivative(newton_min.arg));
+    }
+}
+
+TEST(LocalMinNewtonRCTest, HalleyNeedsFewerEvaluationsThanValueOnlySolver) {
+    for (const auto& problem : smooth_problems) {
+        LocalMinReverseCommunication value_only{problem.from, problem.to};
+        LocalMinNewtonReverseCommunication halley{problem.from, problem.to, SecondOrderStep::Halley};
+        const auto value_only_min = Minimize(value_only, problem.value);
+        const auto halley_min = Minimize(halley, problem);
+
+        EXPECT_NEAR(halley_min.arg, problem.minimizer, 1e-7);
+        EXPECT_LT(halley_min.evaluations, value_only_min.evaluations);
+    }
+}
+
+TEST(LocalMinNewtonRCTest, ConvergesQuadratically) {
+    const auto& problem = smooth_problems[0];
+
+    LocalMinNewtonReverseCommunication newton{problem.from, problem.to};
+    std::vector<double> errors;
+    double arg = newton(0.0, 0.0, 0.0);
+    while (!newton.IsReady()) {
+        errors.push_back(std::fabs(arg - problem.minimizer));
+        arg = newton(problem.value(arg), problem.derivative(arg), problem.second_derivative(arg));
+    }
+
+    // Near the minimizer e[k + 1] ~ C e[k]^2 with C = F''' / (2 F'') = 1 / 2.
+    ASSERT_GE(errors.size(), 3u);
+    for (std::size_t k = 0; k + 1 < errors.size(); ++k) {
+        if (errors[k] < 1e-2 && errors[k + 1] > 1e-14) {
+            EXPECT_LT(errors[k + 1], errors[k] * errors[k]);
+        }
+    }
+}
+
+TEST(LocalMinNewtonRCTest, FallsBackOnNegativeCurvature) {
+    // Starts at the local maximum of cos on [-4, 4], where F'' < 0.
+    LocalMinNewtonReverseCommunication newton{-4.0, 4.0};
+    double arg = newton(0.0, 0.0, 0.0);
+    while (!newton.IsReady()) {
+        arg = newton(std::cos(arg), -std::sin(arg), -std::cos(arg));
+    }
+    EXPECT_NEAR(std::fabs(arg), std::acos(-1.0), 1e-8);
+}
+
+TEST(LocalMinNewtonRCTest, TakesSecantStepsWithoutSecondDerivative) {
+    for (const auto& problem : smooth_problems) {
+        // The secant step converges only linearly where F'' = 0 at the minimizer.
+        if (problem.second_derivative(problem.minimizer) == 0.0) {
+            continue;
+        }
+
+        // F'' is never positive, so only the secant and golden section steps remain.
+        LocalMinNewtonReverseCommunication newton{problem.from, problem.to};
+        int evaluations = 0;
+        double arg = newton(0.0, 0.0, 0.0);
+        while (!newton.IsReady()) {
+            arg = newton(problem.value(arg), problem.derivative(arg), -1.0);
+            ++evaluations;
+        }
+
+        // Golden section steps alone need 24 to 27 evaluations here.
+        EXPECT_NEAR(arg, problem.minimizer, 1e-7);
+        EXPECT_LT(evaluations, 15);
+    }
+}
+
+TEST(LocalMinPiecewiseTest, FindsMinimumAtBreakpointWithFewEvaluations) {
+    // Tiered price with kinks at 1 and 3, the minimum is at the kink at 1.
+    auto function = [](double x) {
+        return 0.1 * (x - 2.3) * (x - 2.3) - 0.3 * x
+            + 2.0 * std::max(0.0, 1.0 - x) + 0.8 * std::max(0.0, x - 1.0) + 0.5 * std::max(0.0, x - 3.0);
+    };
+
+    LocalMinReverseCommunication whole{0.0, 5.0};
+    const auto whole_min = Minimize(whole, function);
+
+    LocalMinPiecewise piecewise{0.0, 5.0, {3.0, 1.0}};
+    const auto piecewise_min = Minimize(piecewise, function);
+
+    EXPECT_EQ(piecewise.Result().arg, 1.0);
+    EXPECT_EQ(piecewise.Result().value, function(1.0));
+    EXPECT_LT(3 * piecewise_min.evaluations, whole_min.evaluations);
+}
+
+TEST(LocalMinPiecewiseTest, FindsInteriorMinimumOfPiece) {
+    auto function = [](double x) {
+        return (x - 2.3) * (x - 2.3) + 0.5 * std::fabs(x - 1.0) + 0.8 * std::max(0.0, x - 3.0);
+    };
+
+    LocalMinPiecewise piecewise{0.0, 5.0, {1.0, 3.0}};
+    Minimize(piecewise, function);
+
+    // F'(x) = 2 (x - 2.3) + 0.5 = 0 on (1, 3)
+    EXPECT_NEAR(piecewise.Result().arg, 2.05, 1e-6);
+}
+
+TEST(LocalMinPiecewiseTest, ReturnsGlobalBestAcrossPieces) {
+    // Two valleys separated by a jump at 2, the right one is deeper.
+    auto function = [](double x) {
+        return x < 2.0 ? (x - 1.0) * (x - 1.0) + 1.0 : (x - 3.5) * (x - 3.5);
+    };
+
+    LocalMinPiecewise piecewise{0.0, 5.0, {2.0}};
+    std::size_t concurrent = 0;
+    std::vector<double> values;
+    while (!piecewise.IsReady()) {
+        values.clear();
+        for (const double arg : piecewise.Args()) {
+            values.push_back(function(arg));
+        }
+        if (values.size() != 5) {
+            concurrent = std::max(concurrent, values.size());
+        }
+        piecewise(values);
+    }
+
+    // Both pieces are searched in the same rounds.
+    EXPECT_EQ(concurrent, 2u);
+    EXPECT_NEAR(piecewise.Result().arg, 3.5, 1e-6);
+}
+
+TEST(LocalMinPiecewiseTest, SearchesPieceNextToDownwardJump) {
+    // F jumps down at 2, but the left piece holds the deeper minimum.
+    auto function = [](double x) {
+        return x < 2.0 ? 0.5 + 4.5 * (x - 1.0) * (x - 1.0) : 2.0 + (x - 2.0);
+    };
+
+    LocalMinPiecewise piecewise{0.0, 5.0, {2.0}};
+    Minimize(piecewise, function);
+
+    EXPECT_NEAR(piecewise.Result().arg, 1.0, 1e-6);
+    EXPECT_NEAR(piecewise.Result().value, 0.5, 1e-12);
+}
+
+TEST(LocalMinPiecewiseTest, SearchesPiecesWithSlopesAtRoundingLevel) {
+    // Over 2 H, the slopes at both breakpoints change F by less than its rounding error.
+    auto offset = [](double x) { return 1e6 + 1e-3 * (x - 1.5) * (x - 1.5); };
+    auto flat = [](double x) { return 1.0 + 1e-9 * (x - 1.5) * (x - 1.5); };
+
+    LocalMinPiecewise offset_piecewise{0.0, 3.0, {1.0, 2.0}};
+    Minimize(offset_piecewise, offset);
+    EXPECT_NEAR(offset_piecewise.Result().arg, 1.5, 1e-3);
+
+    LocalMinPiecewise flat_piecewise{0.0, 3.0, {1.0, 2.0}};
+    Minimize(flat_piecewise, flat);
+    EXPECT_NEAR(flat_piecewise.Result().arg, 1.5, 1e-3);
+}
+
+TEST(LocalMinPiecewiseTest, RejectsBreakpointOutsideInterval) {
+    EXPECT_THROW((LocalMinPiecewise{0.0, 1.0, {0.5, 1.0}}), std::runtime_error);
+    EXPECT_THROW((LocalMinPiecewise{0.0, 1.0, {-0.5}}), std::runtime_error);
+}